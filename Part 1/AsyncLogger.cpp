@@ -0,0 +1,150 @@
+#include "AsyncLogger.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+	constexpr std::chrono::milliseconds IDLE_SLEEP{1};
+	constexpr std::size_t RECORDS_PER_PRODUCER_BATCH = 256;
+
+	std::atomic<std::uint64_t> next_logger_id{1};
+}
+
+// При завершении потока его буферы помечаются завершёнными, и фоновый поток логгера удаляет их после дочитывания.
+// Указатель на буфер разыменовывается только пока логгер жив (id логгеров не повторяются), а флаг - всегда
+struct AsyncLogger::ProducersCache final
+{
+	struct Entry final
+	{
+		std::uint64_t logger_id;
+		Producer *producer;
+		std::shared_ptr<std::atomic<bool>> retired;
+	};
+
+	std::vector<Entry> entries;
+
+	~ProducersCache()
+	{
+		for (const Entry &entry : this->entries)
+			entry.retired->store(true, std::memory_order_release);
+	}
+};
+
+AsyncLogger::AsyncLogger(std::ostream &sink, OverflowPolicy policy)
+	: sink(sink), policy(policy), id(next_logger_id.fetch_add(1, std::memory_order_relaxed)),
+	  worker([this](std::stop_token stop_token) { this->run(stop_token); })
+{}
+
+AsyncLogger::~AsyncLogger()
+{
+	this->worker.request_stop();
+	this->worker.join();
+}
+
+std::size_t AsyncLogger::get_producers_count()
+{
+	std::lock_guard lock(this->producers_mtx);
+	return this->producers.size();
+}
+
+std::string_view AsyncLogger::to_string(LogLevel level) noexcept
+{
+	switch (level)
+	{
+		case LogLevel::VERBOSE:
+			return "DEBUG";
+		case LogLevel::INFO:
+			return "INFO";
+		case LogLevel::WARNING:
+			return "WARNING";
+		case LogLevel::CRITICAL:
+			return "CRITICAL";
+		default:
+			return "UNKNOWN";
+	}
+}
+
+void AsyncLogger::Record::format_to(std::string &out) const
+{
+	std::format_to(std::back_inserter(out), "{:%F %T} [{}] ",
+		std::chrono::floor<std::chrono::milliseconds>(this->time_stamp), AsyncLogger::to_string(this->level));
+	this->format(out, this->fmt, this->storage);
+	out.push_back('\n');
+}
+
+AsyncLogger::Producer& AsyncLogger::local_producer()
+{
+	// Поток может писать в несколько логгеров, поэтому кешируются пары (id логгера, буфер потока).
+	// Регистрация нового потока - единственное место на стороне обработчиков, где берётся мьютекс
+	thread_local ProducersCache cache;
+
+	const auto cached = std::ranges::find(cache.entries, this->id, &ProducersCache::Entry::logger_id);
+	if (cached != cache.entries.end())
+		return *cached->producer;
+
+	std::lock_guard lock(this->producers_mtx);
+	Producer *const producer = this->producers.emplace_back(std::make_unique<Producer>()).get();
+	cache.entries.push_back(ProducersCache::Entry{this->id, producer, producer->retired});
+	return *producer;
+}
+
+void AsyncLogger::run(std::stop_token stop_token)
+{
+	std::string batch;
+	while (!stop_token.stop_requested())
+	{
+		if (!this->drain(batch))
+			std::this_thread::sleep_for(IDLE_SLEEP);
+	}
+
+	// Дописываем всё, что успели положить в буферы до остановки
+	while (this->drain(batch))
+	{
+	}
+}
+
+bool AsyncLogger::drain(std::string &batch)
+{
+	std::vector<Producer*> snapshot;
+	{
+		std::lock_guard lock(this->producers_mtx);
+
+		// Буфер завершившегося потока больше не пополняется: после дочитывания он удаляется,
+		// иначе каждый поток, хоть раз писавший в лог, навсегда занимал бы память и время обхода
+		std::erase_if(this->producers, [](const std::unique_ptr<Producer> &producer)
+		{
+			return producer->retired->load(std::memory_order_acquire) && producer->ring.empty() &&
+				   producer->dropped.load(std::memory_order_relaxed) == 0;
+		});
+
+		snapshot.reserve(this->producers.size());
+		std::ranges::transform(this->producers, std::back_inserter(snapshot), &std::unique_ptr<Producer>::get);
+	}
+
+	batch.clear();
+	for (Producer *producer : snapshot)
+	{
+		if (const std::uint64_t dropped = producer->dropped.exchange(0, std::memory_order_relaxed); dropped > 0)
+		{
+			std::ostringstream thread_id;
+			thread_id << producer->thread_id;
+			std::format_to(std::back_inserter(batch), "{:%F %T} [{}] Logger ring of thread {} overflowed, {} messages dropped\n",
+				std::chrono::floor<std::chrono::milliseconds>(Clock::now()), AsyncLogger::to_string(LogLevel::WARNING), thread_id.str(), dropped);
+		}
+
+		for (std::size_t i = 0; i < RECORDS_PER_PRODUCER_BATCH; ++i)
+		{
+			if (!producer->ring.try_consume([&batch](const Record &record) { record.format_to(batch); }))
+				break;
+		}
+	}
+
+	if (batch.empty())
+		return false;
+
+	this->sink.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+	this->sink.flush();
+	return true;
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "SpscQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Имена уровней не совпадают с DEBUG/ERROR, т.к. они часто определены макросами (-DDEBUG, windows.h)
+enum class LogLevel : std::uint8_t
+{
+	VERBOSE, INFO, WARNING, CRITICAL,
+};
+
+// Минимальный уровень логирования задаётся при сборке (например, /DASYNC_LOGGER_MIN_LEVEL=2).
+// Методы debug/info/... ниже этого уровня ничего не форматируют и не копируют, но аргументы вызова
+// всё равно вычисляются. Чтобы отбросить и их (например, logger->debug("...", expensive())),
+// используйте макрос ASYNC_LOG
+#ifndef ASYNC_LOGGER_MIN_LEVEL
+#ifdef _DEBUG
+#define ASYNC_LOGGER_MIN_LEVEL 0
+#else
+#define ASYNC_LOGGER_MIN_LEVEL 1
+#endif // _DEBUG
+#endif // ASYNC_LOGGER_MIN_LEVEL
+
+class AsyncLogger final
+{
+public:
+	// Поведение при переполнении кольцевого буфера потока:
+	// DROP - сообщение отбрасывается, фоновый поток позже выводит количество потерянных сообщений;
+	// BLOCK - поток-обработчик ждёт, пока фоновый поток не освободит место (задержка снова зависит от диска)
+	enum class OverflowPolicy
+	{
+		DROP, BLOCK,
+	};
+
+	using Clock = std::chrono::system_clock;
+
+	static constexpr LogLevel MIN_LEVEL = static_cast<LogLevel>(ASYNC_LOGGER_MIN_LEVEL);
+	static constexpr std::size_t RING_CAPACITY = 1024;
+	static constexpr std::size_t ARGS_CAPACITY = 96;
+
+public:
+	AsyncLogger() = delete;
+	explicit AsyncLogger(std::ostream &sink, OverflowPolicy policy = OverflowPolicy::DROP);
+	AsyncLogger(const AsyncLogger&) = delete;
+	AsyncLogger& operator=(const AsyncLogger&) = delete;
+	~AsyncLogger();
+
+	template<typename... Args>
+	void debug(std::format_string<Args...> fmt, const Args&... args)
+	{
+		this->log<LogLevel::VERBOSE>(fmt, args...);
+	}
+
+	template<typename... Args>
+	void info(std::format_string<Args...> fmt, const Args&... args)
+	{
+		this->log<LogLevel::INFO>(fmt, args...);
+	}
+
+	template<typename... Args>
+	void warning(std::format_string<Args...> fmt, const Args&... args)
+	{
+		this->log<LogLevel::WARNING>(fmt, args...);
+	}
+
+	template<typename... Args>
+	void critical(std::format_string<Args...> fmt, const Args&... args)
+	{
+		this->log<LogLevel::CRITICAL>(fmt, args...);
+	}
+
+	// Строка формата не копируется: format_string создаётся только из константного выражения,
+	// поэтому её время жизни статическое. Аргументы копируются в буфер без форматирования
+	template<LogLevel level, typename... Args>
+	void log(std::format_string<Args...> fmt, const Args&... args)
+	{
+		if constexpr (level >= MIN_LEVEL)
+		{
+			this->push(level, fmt.get(), args...);
+		}
+	}
+
+	// Количество зарегистрированных буферов потоков; буферы завершившихся потоков удаляются после дочитывания
+	[[nodiscard]] std::size_t get_producers_count();
+
+	[[nodiscard]] static std::string_view to_string(LogLevel level) noexcept;
+
+private:
+	// Указатели на строки сохраняются копией, иначе к моменту форматирования они могут стать висячими
+	template<typename T>
+	using StoredArg = std::conditional_t<
+		std::is_same_v<std::decay_t<T>, const char*> ||
+		std::is_same_v<std::decay_t<T>, char*> ||
+		std::is_same_v<std::decay_t<T>, std::string_view>,
+		std::string, std::decay_t<T>>;
+
+	class Record final
+	{
+	public:
+		template<typename... Args>
+		Record(LogLevel level, std::string_view fmt, const Args&... args)
+			: level(level), time_stamp(Clock::now()), fmt(fmt),
+			  format(&Record::format_thunk<std::tuple<StoredArg<Args>...>>),
+			  destroy(&Record::destroy_thunk<std::tuple<StoredArg<Args>...>>)
+		{
+			using Tuple = std::tuple<StoredArg<Args>...>;
+			static_assert(sizeof(Tuple) <= ARGS_CAPACITY, "Log record arguments exceed AsyncLogger::ARGS_CAPACITY");
+			static_assert(alignof(Tuple) <= alignof(std::max_align_t));
+
+			std::construct_at(reinterpret_cast<Tuple*>(this->storage), args...);
+		}
+
+		Record(const Record&) = delete;
+		Record& operator=(const Record&) = delete;
+
+		~Record()
+		{
+			this->destroy(this->storage);
+		}
+
+		void format_to(std::string &out) const;
+
+	private:
+		using FormatFn = void (*)(std::string &out, std::string_view fmt, const void *args);
+		using DestroyFn = void (*)(void *args) noexcept;
+
+		LogLevel level;
+		Clock::time_point time_stamp;
+		std::string_view fmt;
+		FormatFn format;
+		DestroyFn destroy;
+		alignas(std::max_align_t) std::byte storage[ARGS_CAPACITY];
+
+		template<typename Tuple>
+		static void format_thunk(std::string &out, std::string_view fmt, const void *args)
+		{
+			std::apply([&](const auto&... unpacked)
+			{
+				std::vformat_to(std::back_inserter(out), fmt, std::make_format_args(unpacked...));
+			}, *std::launder(static_cast<const Tuple*>(args)));
+		}
+
+		template<typename Tuple>
+		static void destroy_thunk(void *args) noexcept
+		{
+			std::destroy_at(std::launder(static_cast<Tuple*>(args)));
+		}
+	};
+
+	// Кольцевой буфер одного потока-обработчика; читает его только фоновый поток логгера.
+	// Флаг retired поток выставляет при завершении. Он хранится отдельно от буфера, т.к. логгер
+	// может быть разрушен раньше потока, и тогда поток обращается только к флагу
+	struct Producer final
+	{
+		SpscQueue<Record, RING_CAPACITY> ring;
+		std::thread::id thread_id = std::this_thread::get_id();
+		std::atomic<std::uint64_t> dropped{0};
+		std::shared_ptr<std::atomic<bool>> retired = std::make_shared<std::atomic<bool>>(false);
+	};
+
+	// Буферы потока во всех логгерах, в которые он писал (thread_local в local_producer)
+	struct ProducersCache;
+
+	std::ostream &sink;
+	OverflowPolicy policy;
+	std::uint64_t id;
+
+	std::mutex producers_mtx;
+	std::vector<std::unique_ptr<Producer>> producers;
+
+	std::jthread worker; // объявлен последним, чтобы стартовать после инициализации остальных членов
+
+	template<typename... Args>
+	void push(LogLevel level, std::string_view fmt, const Args&... args)
+	{
+		Producer &producer = this->local_producer();
+
+		if (producer.ring.try_emplace(level, fmt, args...))
+			return;
+
+		if (this->policy == OverflowPolicy::DROP)
+		{
+			producer.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		do
+		{
+			std::this_thread::yield();
+		}
+		while (!producer.ring.try_emplace(level, fmt, args...));
+	}
+
+	[[nodiscard]] Producer& local_producer();
+
+	void run(std::stop_token stop_token);
+	bool drain(std::string &batch);
+};
+
+// ASYNC_LOG(logger, WARNING, "Client {} can't afford item {}", id, item_id);
+// Вызов ниже MIN_LEVEL находится в отброшенной ветке if constexpr, поэтому аргументы не вычисляются
+#define ASYNC_LOG(logger, level, ...) \
+	do \
+	{ \
+		if constexpr (LogLevel::level >= AsyncLogger::MIN_LEVEL) \
+			(logger)->template log<LogLevel::level>(__VA_ARGS__); \
+	} \
+	while (false)
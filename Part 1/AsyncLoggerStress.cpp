@@ -0,0 +1,329 @@
+// Стресс-тест SpscQueue и AsyncLogger и замер задержки обработчика при медленном приёмнике логов:
+// проверяет порядок элементов в кольцевом буфере, подсчёт потерь при OverflowPolicy::DROP,
+// отсутствие потерь при OverflowPolicy::BLOCK, дочитывание и удаление буферов завершившихся потоков
+// и отсечение ASYNC_LOG, затем сравнивает задержку вызова logger.info с синхронной записью в тот же приёмник
+#include "AsyncLogger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+static_assert(AsyncLogger::MIN_LEVEL > LogLevel::VERBOSE,
+	"AsyncLoggerStress checks that ASYNC_LOG skips VERBOSE calls: build it with ASYNC_LOGGER_MIN_LEVEL >= 1 (e.g. Release)");
+
+namespace
+{
+	using namespace std::chrono_literals;
+
+	// Приёмник, каждая запись в который занимает delay - модель медленного диска
+	class SlowStreamBuf final : public std::streambuf
+	{
+	public:
+		explicit SlowStreamBuf(std::chrono::microseconds delay) noexcept
+			: delay(delay)
+		{}
+
+		[[nodiscard]] const std::string& get_data() const noexcept
+		{
+			return this->data;
+		}
+
+	protected:
+		std::streamsize xsputn(const char *s, std::streamsize count) override
+		{
+			std::this_thread::sleep_for(this->delay);
+			this->data.append(s, static_cast<std::size_t>(count));
+			return count;
+		}
+
+		int_type overflow(int_type ch) override
+		{
+			if (!traits_type::eq_int_type(ch, traits_type::eof()))
+				this->data.push_back(traits_type::to_char_type(ch));
+			return traits_type::not_eof(ch);
+		}
+
+	private:
+		std::chrono::microseconds delay;
+		std::string data;
+	};
+
+	bool all_passed = true;
+
+	void report(bool passed, std::string_view msg)
+	{
+		all_passed = all_passed && passed;
+		std::cout << std::format("{} {}\n", passed ? "[OK]  " : "[FAIL]", msg);
+	}
+
+	struct LogSummary final
+	{
+		std::uint64_t messages_count = 0;
+		std::uint64_t dropped_count = 0;
+		bool ordered = true; // сообщения каждого потока идут по возрастанию seq
+	};
+
+	// Разбирает строки "... producer <p> seq <s>" и "... overflowed, <n> messages dropped"
+	LogSummary summarize(const std::string &log, std::size_t producers_count)
+	{
+		static constexpr std::string_view PRODUCER = "producer ";
+		static constexpr std::string_view SEQ = " seq ";
+		static constexpr std::string_view DROPPED = "overflowed, ";
+
+		LogSummary summary;
+		std::vector<std::int64_t> last_seq(producers_count, -1);
+
+		std::istringstream lines(log);
+		for (std::string line; std::getline(lines, line);)
+		{
+			if (const std::size_t pos = line.find(DROPPED); pos != std::string::npos)
+			{
+				std::uint64_t dropped = 0;
+				std::from_chars(line.data() + pos + DROPPED.size(), line.data() + line.size(), dropped);
+				summary.dropped_count += dropped;
+				continue;
+			}
+
+			const std::size_t producer_pos = line.find(PRODUCER);
+			const std::size_t seq_pos = line.find(SEQ);
+			if (producer_pos == std::string::npos || seq_pos == std::string::npos)
+				continue;
+
+			std::size_t producer = 0;
+			std::int64_t seq = 0;
+			std::from_chars(line.data() + producer_pos + PRODUCER.size(), line.data() + seq_pos, producer);
+			std::from_chars(line.data() + seq_pos + SEQ.size(), line.data() + line.size(), seq);
+
+			++summary.messages_count;
+			if (producer >= producers_count || seq <= last_seq[producer])
+				summary.ordered = false;
+			else
+				last_seq[producer] = seq;
+		}
+		return summary;
+	}
+
+	void spsc_ordering()
+	{
+		constexpr std::uint64_t items_count = 1'000'000;
+
+		// unique_ptr: под ASan заодно проверяется, что элементы уничтожаются ровно один раз
+		SpscQueue<std::unique_ptr<std::uint64_t>, 1024> queue;
+		std::jthread producer([&queue]
+		{
+			for (std::uint64_t i = 0; i < items_count; ++i)
+			{
+				while (!queue.try_emplace(std::make_unique<std::uint64_t>(i)))
+					std::this_thread::yield();
+			}
+		});
+
+		std::uint64_t expected = 0;
+		bool ordered = true;
+		while (expected < items_count)
+		{
+			const bool consumed = queue.try_consume([&](std::unique_ptr<std::uint64_t> &item)
+			{
+				ordered = ordered && *item == expected;
+				++expected;
+			});
+			if (!consumed)
+				std::this_thread::yield();
+		}
+		producer.join();
+
+		report(ordered && queue.empty(), std::format("SpscQueue keeps FIFO order of {} items", items_count));
+	}
+
+	// Пишет messages_count сообщений из каждого из producers_count потоков и возвращает журнал
+	std::string log_burst(AsyncLogger::OverflowPolicy policy, std::chrono::microseconds sink_delay,
+		std::size_t producers_count, std::uint64_t messages_count)
+	{
+		SlowStreamBuf buffer(sink_delay);
+		std::ostream sink(&buffer);
+		{
+			AsyncLogger logger(sink, policy);
+			std::vector<std::jthread> producers;
+			for (std::size_t producer = 0; producer < producers_count; ++producer)
+			{
+				producers.emplace_back([&logger, producer, messages_count]
+				{
+					for (std::uint64_t seq = 0; seq < messages_count; ++seq)
+						logger.info("producer {} seq {}", producer, seq);
+				});
+			}
+		}
+		return buffer.get_data();
+	}
+
+	void drop_counting()
+	{
+		constexpr std::size_t producers_count = 4;
+		constexpr std::uint64_t messages_count = 20'000;
+
+		const LogSummary summary = summarize(log_burst(AsyncLogger::OverflowPolicy::DROP, 1ms, producers_count, messages_count), producers_count);
+
+		const bool passed = summary.dropped_count > 0 && summary.ordered &&
+							summary.messages_count + summary.dropped_count == producers_count * messages_count;
+
+		report(passed, std::format("DROP: written {} + reported dropped {} == sent {}",
+			summary.messages_count, summary.dropped_count, producers_count * messages_count));
+	}
+
+	void block_lossless()
+	{
+		constexpr std::size_t producers_count = 4;
+		constexpr std::uint64_t messages_count = 5'000;
+
+		const LogSummary summary = summarize(log_burst(AsyncLogger::OverflowPolicy::BLOCK, 1ms, producers_count, messages_count), producers_count);
+
+		const bool passed = summary.dropped_count == 0 && summary.ordered &&
+							summary.messages_count == producers_count * messages_count;
+
+		report(passed, std::format("BLOCK: all {} messages written in per-thread order", producers_count * messages_count));
+	}
+
+	void finished_producers_drained()
+	{
+		constexpr std::size_t producers_count = 16;
+		constexpr std::uint64_t messages_count = 100;
+
+		std::ostringstream sink;
+		bool released = false;
+		{
+			AsyncLogger logger(sink);
+			for (std::size_t producer = 0; producer < producers_count; ++producer)
+			{
+				// Поток завершается сразу после записи, его буфер дочитывается позже
+				std::jthread([&logger, producer]
+				{
+					for (std::uint64_t seq = 0; seq < messages_count; ++seq)
+						logger.info("producer {} seq {}", producer, seq);
+				}).join();
+			}
+
+			// Буферы завершившихся потоков удаляются фоновым потоком после дочитывания
+			const auto deadline = std::chrono::steady_clock::now() + 1s;
+			while (!(released = logger.get_producers_count() == 0) && std::chrono::steady_clock::now() < deadline)
+				std::this_thread::sleep_for(1ms);
+		}
+
+		const LogSummary summary = summarize(sink.str(), producers_count);
+		report(summary.ordered && summary.dropped_count == 0 && summary.messages_count == producers_count * messages_count && released,
+			std::format("Rings of {} finished threads are drained and released", producers_count));
+	}
+
+	void async_log_macro()
+	{
+		std::ostringstream sink;
+		int side_effects_count = 0;
+		const auto side_effect = [&side_effects_count] { return ++side_effects_count; };
+		{
+			AsyncLogger logger(sink);
+			ASYNC_LOG(&logger, VERBOSE, "verbose {}", side_effect());
+			ASYNC_LOG(&logger, WARNING, "warning {}", side_effect());
+		}
+
+		const std::string log = sink.str();
+		const bool passed = side_effects_count == 1 && log.find("verbose") == std::string::npos &&
+							log.find("[WARNING] warning 1") != std::string::npos;
+
+		report(passed, "ASYNC_LOG skips arguments below MIN_LEVEL and writes enabled levels");
+	}
+
+	struct Percentiles final
+	{
+		std::chrono::nanoseconds p50;
+		std::chrono::nanoseconds p99;
+		std::chrono::nanoseconds max;
+	};
+
+	Percentiles percentiles(std::vector<std::chrono::nanoseconds> &latencies)
+	{
+		std::ranges::sort(latencies);
+		return Percentiles{latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100], latencies.back()};
+	}
+
+	// Задержка "обработчика" (одного вызова логирования) при записи в приёмник с задержкой sink_delay
+	template<typename LogCall>
+	Percentiles measure_handler_latency(std::uint64_t calls_count, LogCall &&log_call)
+	{
+		std::vector<std::chrono::nanoseconds> latencies;
+		latencies.reserve(calls_count);
+		for (std::uint64_t i = 0; i < calls_count; ++i)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			log_call(i);
+			latencies.push_back(std::chrono::steady_clock::now() - start);
+
+			// Остальная работа обработчика пакета
+			const auto work_until = std::chrono::steady_clock::now() + 20us;
+			while (std::chrono::steady_clock::now() < work_until)
+			{
+			}
+		}
+		return percentiles(latencies);
+	}
+
+	void handler_latency()
+	{
+		constexpr std::uint64_t calls_count = 5'000;
+		constexpr std::chrono::microseconds sink_delay = 500us;
+
+		Percentiles sync_latency;
+		{
+			SlowStreamBuf buffer(sink_delay);
+			std::ostream sink(&buffer);
+			std::mutex sink_mtx;
+			sync_latency = measure_handler_latency(calls_count, [&](std::uint64_t i)
+			{
+				const std::string line = std::format("Client {} bought item {}\n", i, i % 100);
+				std::lock_guard lock(sink_mtx);
+				sink.write(line.data(), static_cast<std::streamsize>(line.size()));
+				sink.flush();
+			});
+		}
+
+		Percentiles async_latency;
+		{
+			SlowStreamBuf buffer(sink_delay);
+			std::ostream sink(&buffer);
+			AsyncLogger logger(sink);
+			async_latency = measure_handler_latency(calls_count, [&](std::uint64_t i)
+			{
+				logger.info("Client {} bought item {}", i, i % 100);
+			});
+		}
+
+		const auto us = [](std::chrono::nanoseconds value) { return std::chrono::duration<double, std::micro>(value).count(); };
+
+		std::cout << std::format("\nHandler latency, {} calls, sink write takes {} us:\n", calls_count, sink_delay.count());
+		std::cout << std::format("{:>8} {:>12} {:>12} {:>12}\n", "logger", "p50, us", "p99, us", "max, us");
+		std::cout << std::format("{:>8} {:>12.2f} {:>12.2f} {:>12.2f}\n", "sync", us(sync_latency.p50), us(sync_latency.p99), us(sync_latency.max));
+		std::cout << std::format("{:>8} {:>12.2f} {:>12.2f} {:>12.2f}\n", "async", us(async_latency.p50), us(async_latency.p99), us(async_latency.max));
+	}
+}
+
+int main()
+{
+	spsc_ordering();
+	drop_counting();
+	block_lossless();
+	finished_producers_drained();
+	async_log_macro();
+	handler_latency();
+
+	return all_passed ? 0 : 1;
+}
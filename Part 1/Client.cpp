@@ -110,6 +110,7 @@ void Client::login(const client::Packet *packet)
 	data.net_id = net_id;
 	data.net_type = net_type;
 	
+	// Колбэк выполняется в потоке Requests, а не в потоке шарда (см. комментарий к Client)
 	this->requests->add(&data, [&](const vector<Player*> &loaded) -> void
 	{
 		// Если гарантируется, что !loaded.empty(), то можно обернуть проверку в ifdef
@@ -11,6 +11,10 @@
 #include <memory>
 #include <string>
 
+// Экземпляр принадлежит одному шарду ShardedExecutor<Client>: on_packet/on_event, вызванные через
+// executor.post, выполняются только в потоке этого шарда и изменяют состояние Player без блокировок
+// (см. ShardedExecutor.h). Колбэк Requests::add в login вызывается потоком Requests и под эту
+// гарантию не попадает: изменять из него Player можно только перевыставив работу через executor.post
 class Client final
 {
 public:
@@ -20,6 +24,7 @@ public:
 	void disconnect() const;
 	void send(const server::Packet &packet) const;
 	void on_event(const ClientEvent &event);
+	void on_packet(const server::Packet &packet);
 
 private:
 	IO *io;
@@ -28,8 +33,6 @@ private:
 
 	[[nodiscard]] auto get_ip() const -> IP;
 
-	void on_packet(const server::Packet &packet);
-
 	// Примеры обработчиков пакетов
 	void params_set(const server::Packet &packet) const;
 	void buy(const server::Packet &packet);
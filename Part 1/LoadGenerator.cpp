@@ -0,0 +1,137 @@
+// Локальный генератор нагрузки для ShardedExecutor: моделирует множество клиентов,
+// которые покупают предметы и передают друг другу "ход" (межшардовые сообщения),
+// и показывает, как пропускная способность масштабируется с количеством ядер
+#include "ShardedExecutor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// Упрощённая модель Player: баланс и инвентарь меняются без блокировок,
+	// т.к. сессия принадлежит ровно одному шарду
+	class SimulatedClient final
+	{
+	public:
+		explicit SimulatedClient(std::uint64_t balance) noexcept
+			: balance(balance)
+		{}
+
+		void buy(std::uint32_t item_id)
+		{
+			const std::uint64_t price = item_id % 16 + 1;
+			if (this->balance < price)
+			{
+				this->balance += 1000; // "пополнение", чтобы клиент не выпадал из нагрузки
+				return;
+			}
+
+			this->balance -= price;
+			this->inventory.push_back(item_id);
+			if (this->inventory.size() > 64)
+				this->inventory.clear();
+		}
+
+	private:
+		std::uint64_t balance;
+		std::vector<std::uint32_t> inventory;
+	};
+
+	using Executor = ShardedExecutor<SimulatedClient>;
+
+	// Пакет BUY, который после обработки пересылается случайному клиенту (возможно, на другой шард)
+	struct BuyTask final
+	{
+		Executor *executor;
+		std::atomic<std::uint64_t> *finished;
+		std::uint64_t clients_count;
+		std::uint64_t rng_state;
+		std::uint32_t hops_left;
+
+		void operator()(SimulatedClient &client)
+		{
+			// xorshift64: достаточно для генерации нагрузки и не требует общего состояния
+			this->rng_state ^= this->rng_state << 13;
+			this->rng_state ^= this->rng_state >> 7;
+			this->rng_state ^= this->rng_state << 17;
+
+			client.buy(static_cast<std::uint32_t>(this->rng_state));
+
+			if (--this->hops_left == 0)
+			{
+				this->finished->fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			this->executor->post(this->rng_state % this->clients_count, BuyTask(*this));
+		}
+	};
+
+	struct RunResult final
+	{
+		std::uint64_t messages;
+		std::chrono::duration<double> elapsed;
+	};
+
+	RunResult run(std::size_t shards_count, std::uint64_t clients_count, std::uint32_t hops)
+	{
+		Executor executor(shards_count);
+		for (std::uint64_t id = 0; id < clients_count; ++id)
+			executor.attach(id, std::make_unique<SimulatedClient>(1000));
+
+		// Пакеты пересылаются между шардами, поэтому начинать можно только когда подключены все клиенты
+		std::atomic<std::uint64_t> attached = 0;
+		for (std::uint64_t id = 0; id < clients_count; ++id)
+			executor.post(id, [&attached](SimulatedClient&) { attached.fetch_add(1, std::memory_order_relaxed); });
+		while (attached.load(std::memory_order_relaxed) < clients_count)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		std::atomic<std::uint64_t> finished = 0;
+		const auto start = std::chrono::steady_clock::now();
+
+		for (std::uint64_t id = 0; id < clients_count; ++id)
+			executor.post(id, BuyTask{&executor, &finished, clients_count, id * 0x9E3779B97F4A7C15ull + 1, hops});
+
+		while (finished.load(std::memory_order_relaxed) < clients_count)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		return RunResult{clients_count * hops, std::chrono::steady_clock::now() - start};
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	const std::size_t max_shards = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+	const std::uint64_t clients_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100'000;
+	const std::uint32_t hops = argc > 3 ? static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 100;
+
+	if (max_shards == 0 || clients_count == 0 || hops == 0)
+	{
+		std::cerr << "Usage: LoadGenerator [max_shards] [clients_count] [hops_per_client]\n";
+		return 1;
+	}
+
+	std::cout << std::format("clients: {}, packets per client: {}\n", clients_count, hops);
+	std::cout << std::format("{:>7} {:>12} {:>10} {:>12} {:>8}\n", "shards", "packets", "seconds", "Mpackets/s", "speedup");
+
+	double base_rate = 0.;
+	for (std::size_t shards_count = 1; shards_count <= max_shards; shards_count *= 2)
+	{
+		const RunResult result = run(shards_count, clients_count, hops);
+		const double rate = static_cast<double>(result.messages) / result.elapsed.count();
+		if (shards_count == 1)
+			base_rate = rate;
+
+		std::cout << std::format("{:>7} {:>12} {:>10.3f} {:>12.2f} {:>8.2f}\n",
+			shards_count, result.messages, result.elapsed.count(), rate / 1e6, rate / base_rate);
+	}
+
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include "ShardedExecutor.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+void pin_current_thread_to_core(std::size_t core) noexcept
+{
+#ifdef _WIN32
+	if (core < sizeof(DWORD_PTR) * 8)
+		SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << core);
+#elif defined(__linux__)
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	CPU_SET(core, &cpu_set);
+	pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+	static_cast<void>(core);
+#endif
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "SpscQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Привязывает текущий поток к ядру core (если платформа это поддерживает)
+void pin_current_thread_to_core(std::size_t core) noexcept;
+
+// Исполнитель "поток на ядро": каждый шард крутит собственный цикл событий и единолично владеет
+// своими сессиями (например, Client). Сессия всегда обрабатывается одним и тем же потоком,
+// поэтому её состояние (Player::balance, Player::inventory) изменяется без блокировок.
+// Шарды обмениваются сообщениями через lock-free SPSC очереди: у каждого шарда есть входящая
+// очередь от каждого другого шарда. Внешние потоки (сетевые, их может быть несколько) пишут
+// в общую для них входящую очередь шарда под мьютексом
+template<typename Session, std::size_t QueueCapacity = 512>
+class ShardedExecutor final
+{
+public:
+	using SessionId = std::uint64_t;
+
+public:
+	ShardedExecutor() = delete;
+	explicit ShardedExecutor(std::size_t shards_count, bool pin_to_cores = true)
+	{
+		assert(("Argument 'shards_count' in constructor of ShardedExecutor must not be zero", shards_count > 0));
+
+		this->shards.reserve(shards_count);
+		for (std::size_t i = 0; i < shards_count; ++i)
+			this->shards.emplace_back(std::make_unique<Shard>(shards_count, i));
+
+		// Потоки запускаются только после создания всех очередей, т.к. обращаются к чужим шардам
+		for (std::size_t i = 0; i < shards_count; ++i)
+		{
+			this->shards[i]->thread = std::jthread([this, i, pin_to_cores](std::stop_token stop_token)
+			{
+				if (pin_to_cores)
+					pin_current_thread_to_core(i % std::max(1u, std::thread::hardware_concurrency()));
+				this->run(i, stop_token);
+			});
+		}
+	}
+
+	ShardedExecutor(const ShardedExecutor&) = delete;
+	ShardedExecutor& operator=(const ShardedExecutor&) = delete;
+
+	~ShardedExecutor()
+	{
+		// Сначала останавливаются все потоки и лишь затем разрушаются очереди, в которые они пишут
+		for (const auto &shard : this->shards)
+			shard->thread.request_stop();
+		for (const auto &shard : this->shards)
+			shard->thread.join();
+	}
+
+	[[nodiscard]] std::size_t get_shards_count() const noexcept
+	{
+		return this->shards.size();
+	}
+
+	[[nodiscard]] std::size_t shard_of(SessionId id) const noexcept
+	{
+		return static_cast<std::size_t>(id % this->shards.size());
+	}
+
+	void attach(SessionId id, std::unique_ptr<Session> session)
+	{
+		this->send(this->shard_of(id), [id, session = std::move(session)](Shard &shard) mutable
+		{
+			shard.sessions.insert_or_assign(id, std::move(session));
+		});
+	}
+
+	void detach(SessionId id)
+	{
+		this->send(this->shard_of(id), [id](Shard &shard)
+		{
+			shard.sessions.erase(id);
+		});
+	}
+
+	// Выполняет func(Session&) в потоке шарда-владельца сессии id.
+	// Если сессия к этому моменту уже отключена, func не вызывается
+	template<std::invocable<Session&> Func>
+	void post(SessionId id, Func &&func)
+	{
+		this->send(this->shard_of(id), [id, func = std::forward<Func>(func)](Shard &shard) mutable
+		{
+			if (const auto session = shard.sessions.find(id); session != shard.sessions.end())
+				func(*session->second);
+		});
+	}
+
+private:
+	struct Shard;
+
+	using Message = std::move_only_function<void(Shard&)>;
+	using Queue = SpscQueue<Message, QueueCapacity>;
+
+	static constexpr std::size_t MESSAGES_PER_QUEUE_BATCH = 64;
+	static constexpr unsigned IDLE_SPINS = 64;
+	static constexpr std::chrono::microseconds IDLE_SLEEP{50};
+
+	struct Shard final
+	{
+		std::unordered_map<SessionId, std::unique_ptr<Session>> sessions;
+
+		// inbox[src] - очередь от шарда src. Очереди к самому себе нет (nullptr): такие сообщения
+		// шард кладёт в собственный backlog
+		std::vector<std::unique_ptr<Queue>> inbox;
+
+		// Сообщения от внешних потоков. has_ingress позволяет не брать мьютекс, пока очередь пуста;
+		// ingress_batch принадлежит потоку шарда и переиспользует память между обменами с ingress
+		std::mutex ingress_mtx;
+		std::vector<Message> ingress;
+		std::vector<Message> ingress_batch;
+		std::atomic<bool> has_ingress{false};
+
+		// backlog[dst] - сообщения шарду dst, не поместившиеся в его очередь (принадлежит потоку шарда).
+		// Вместо ожидания отправитель откладывает сообщение, иначе два шарда с заполненными
+		// очередями друг к другу заблокировались бы навсегда
+		std::vector<std::deque<Message>> backlog;
+
+		std::jthread thread;
+
+		Shard(std::size_t shards_count, std::size_t index)
+			: backlog(shards_count)
+		{
+			this->inbox.reserve(shards_count);
+			for (std::size_t src = 0; src < shards_count; ++src)
+				this->inbox.emplace_back(src != index ? std::make_unique<Queue>() : nullptr);
+		}
+	};
+
+	struct CurrentShard final
+	{
+		const ShardedExecutor *owner = nullptr;
+		std::size_t index = 0;
+	};
+
+	inline static thread_local CurrentShard current_shard;
+
+	std::vector<std::unique_ptr<Shard>> shards;
+
+	void send(std::size_t dst, Message message)
+	{
+		if (current_shard.owner == this)
+		{
+			Shard &self = *this->shards[current_shard.index];
+			// Сохраняем порядок: пока есть отложенные сообщения, новые встают за ними
+			if (dst == current_shard.index || !self.backlog[dst].empty() ||
+				!this->shards[dst]->inbox[current_shard.index]->try_emplace(std::move(message)))
+			{
+				self.backlog[dst].push_back(std::move(message));
+			}
+			return;
+		}
+
+		// Внешний поток не имеет своего цикла, поэтому при переполнении он ждёт - это backpressure
+		Shard &target = *this->shards[dst];
+		std::unique_lock lock(target.ingress_mtx);
+		while (target.ingress.size() >= QueueCapacity)
+		{
+			lock.unlock();
+			std::this_thread::yield();
+			lock.lock();
+		}
+		target.ingress.push_back(std::move(message));
+		target.has_ingress.store(true, std::memory_order_release);
+	}
+
+	void run(std::size_t index, std::stop_token stop_token)
+	{
+		current_shard = CurrentShard{this, index};
+		Shard &self = *this->shards[index];
+
+		unsigned idle_rounds = 0;
+		while (!stop_token.stop_requested())
+		{
+			const bool busy = this->flush_backlog(index) | this->process_inbox(self) | this->process_ingress(self);
+			if (busy)
+			{
+				idle_rounds = 0;
+			}
+			else if (++idle_rounds < IDLE_SPINS)
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				std::this_thread::sleep_for(IDLE_SLEEP);
+			}
+		}
+
+		current_shard = CurrentShard{};
+	}
+
+	bool process_inbox(Shard &self)
+	{
+		bool busy = false;
+		for (const auto &queue : self.inbox)
+		{
+			if (!queue)
+				continue;
+
+			for (std::size_t i = 0; i < MESSAGES_PER_QUEUE_BATCH; ++i)
+			{
+				if (!queue->try_consume([&self](Message &message) { message(self); }))
+					break;
+				busy = true;
+			}
+		}
+		return busy;
+	}
+
+	bool process_ingress(Shard &self)
+	{
+		if (!self.has_ingress.load(std::memory_order_acquire))
+			return false;
+
+		{
+			std::lock_guard lock(self.ingress_mtx);
+			self.ingress.swap(self.ingress_batch);
+			self.has_ingress.store(false, std::memory_order_relaxed);
+		}
+
+		// Обработчики выполняются без мьютекса, чтобы не задерживать внешние потоки
+		for (Message &message : self.ingress_batch)
+			message(self);
+
+		const bool busy = !self.ingress_batch.empty();
+		self.ingress_batch.clear();
+		return busy;
+	}
+
+	bool flush_backlog(std::size_t index)
+	{
+		Shard &self = *this->shards[index];
+		bool busy = false;
+		for (std::size_t dst = 0; dst < self.backlog.size(); ++dst)
+		{
+			std::deque<Message> &pending = self.backlog[dst];
+			if (dst == index)
+			{
+				// Сообщения самому себе выполняются здесь, а не внутри отправившего их обработчика.
+				// Количество фиксируется заранее: обработчики могут дописывать в этот же backlog
+				for (std::size_t count = pending.size(); count > 0; --count)
+				{
+					Message message = std::move(pending.front());
+					pending.pop_front();
+					message(self);
+					busy = true;
+				}
+				continue;
+			}
+
+			Queue &queue = *this->shards[dst]->inbox[index];
+			while (!pending.empty() && queue.try_emplace(std::move(pending.front())))
+			{
+				pending.pop_front();
+				busy = true;
+			}
+		}
+		return busy;
+	}
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Кольцевой lock-free буфер "один писатель - один читатель".
+// Элементы конструируются и уничтожаются прямо в слотах буфера, поэтому T
+// не обязан быть ни копируемым, ни перемещаемым.
+template<typename T, std::size_t Capacity>
+class SpscQueue final
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity of SpscQueue must be a power of two");
+
+public:
+	SpscQueue() = default;
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	~SpscQueue()
+	{
+		while (this->try_consume([](T&) noexcept {}))
+		{
+		}
+	}
+
+	// Вызывается только потоком-писателем. Возвращает false, если буфер заполнен
+	template<typename... Args>
+	[[nodiscard]] bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+	{
+		const std::size_t tail = this->tail.load(std::memory_order_relaxed);
+		if (tail - this->head_cache == Capacity)
+		{
+			this->head_cache = this->head.load(std::memory_order_acquire);
+			if (tail - this->head_cache == Capacity)
+				return false;
+		}
+
+		std::construct_at(this->storage(tail), std::forward<Args>(args)...);
+		this->tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Вызывается только потоком-читателем. Передаёт первый элемент в func и уничтожает его.
+	// Возвращает false, если буфер пуст
+	template<std::invocable<T&> Func>
+	bool try_consume(Func &&func) noexcept(std::is_nothrow_invocable_v<Func, T&>)
+	{
+		const std::size_t head = this->head.load(std::memory_order_relaxed);
+		if (head == this->tail_cache)
+		{
+			this->tail_cache = this->tail.load(std::memory_order_acquire);
+			if (head == this->tail_cache)
+				return false;
+		}
+
+		T *const item = this->item(head);
+		std::forward<Func>(func)(*item);
+		std::destroy_at(item);
+		this->head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return this->head.load(std::memory_order_acquire) == this->tail.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] static constexpr std::size_t capacity() noexcept
+	{
+		return Capacity;
+	}
+
+private:
+	struct alignas(T) Slot
+	{
+		std::byte storage[sizeof(T)];
+	};
+
+	// 64 - типичный размер кеш-линии; std::hardware_destructive_interference_size поддерживается не всеми компиляторами
+	static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+	alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head{0};
+	std::size_t tail_cache = 0; // используется только читателем
+
+	alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail{0};
+	std::size_t head_cache = 0; // используется только писателем
+
+	alignas(CACHE_LINE_SIZE) std::array<Slot, Capacity> slots;
+
+	// Память слота для конструирования элемента: объекта T там ещё нет, поэтому без std::launder
+	[[nodiscard]] T* storage(std::size_t index) noexcept
+	{
+		return reinterpret_cast<T*>(this->slots[index & (Capacity - 1)].storage);
+	}
+
+	// Уже сконструированный в слоте элемент
+	[[nodiscard]] T* item(std::size_t index) noexcept
+	{
+		return std::launder(this->storage(index));
+	}
+};
@@ -0,0 +1,101 @@
+#include "LoginAnalytics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+
+namespace
+{
+	// С этим компаратором std::*_heap строят min-кучу: в начале - устройство с наименьшим количеством логинов
+	bool has_more_logins(const LoginAnalytics::DeviceLogins &lhs, const LoginAnalytics::DeviceLogins &rhs) noexcept
+	{
+		return lhs.logins_count > rhs.logins_count;
+	}
+}
+
+LoginAnalytics::LoginAnalytics(std::size_t top_devices_count, std::size_t days_window)
+	: day_buckets(days_window, DayBucket{std::chrono::sys_days::min(), 0}), top_devices_count(top_devices_count)
+{
+	assert(("Argument 'top_devices_count' in constructor of LoginAnalytics must not be zero", top_devices_count > 0));
+	assert(("Argument 'days_window' in constructor of LoginAnalytics must not be zero", days_window > 0));
+
+	this->top_devices.reserve(top_devices_count);
+}
+
+void LoginAnalytics::on_login(Device device, TimeStamp login_time)
+{
+	const std::chrono::sys_days login_day = std::chrono::floor<std::chrono::days>(login_time);
+	const auto days_window = static_cast<std::int64_t>(this->day_buckets.size());
+	const auto bucket_index = static_cast<std::size_t>(
+		(login_day.time_since_epoch().count() % days_window + days_window) % days_window);
+
+	std::lock_guard lock(mtx);
+
+	const LoginsCount logins_count = ++this->device_logins[device];
+	this->update_top_devices(device, logins_count);
+
+	DayBucket &bucket = this->day_buckets[bucket_index];
+	if (bucket.day < login_day)
+	{
+		bucket = DayBucket{login_day, 0};
+	}
+	// Логин старше дня, уже занимающего корзину, вышел за окно и в среднее не попадает
+	if (bucket.day == login_day)
+	{
+		++bucket.logins_count;
+	}
+}
+
+std::vector<LoginAnalytics::DeviceLogins> LoginAnalytics::get_top_devices() const
+{
+	std::unique_lock lock(mtx);
+	std::vector<DeviceLogins> top_devices_copy = this->top_devices;
+	lock.unlock();
+
+	std::ranges::sort(top_devices_copy, has_more_logins);
+	return top_devices_copy;
+}
+
+std::optional<double> LoginAnalytics::get_average_logins_per_day(std::chrono::sys_days today) const noexcept
+{
+	const std::chrono::sys_days first_day = today - std::chrono::days(static_cast<std::chrono::days::rep>(this->day_buckets.size() - 1));
+
+	LoginsCount logins_count = 0;
+	std::size_t active_days_count = 0;
+
+	std::lock_guard lock(mtx);
+	for (const DayBucket &bucket : this->day_buckets)
+	{
+		if (bucket.logins_count > 0 && bucket.day >= first_day)
+		{
+			logins_count += bucket.logins_count;
+			++active_days_count;
+		}
+	}
+
+	if (active_days_count == 0)
+		return std::nullopt;
+
+	return static_cast<double>(logins_count) / static_cast<double>(active_days_count);
+}
+
+void LoginAnalytics::update_top_devices(Device device, LoginsCount logins_count)
+{
+	// Счётчики только растут, поэтому устройство может попасть в топ, лишь обогнав минимум кучи
+	if (const auto tracked = std::ranges::find(this->top_devices, device, &DeviceLogins::device); tracked != this->top_devices.end())
+	{
+		tracked->logins_count = logins_count;
+		std::ranges::make_heap(this->top_devices, has_more_logins);
+	}
+	else if (this->top_devices.size() < this->top_devices_count)
+	{
+		this->top_devices.push_back(DeviceLogins{device, logins_count});
+		std::ranges::push_heap(this->top_devices, has_more_logins);
+	}
+	else if (logins_count > this->top_devices.front().logins_count)
+	{
+		std::ranges::pop_heap(this->top_devices, has_more_logins);
+		this->top_devices.back() = DeviceLogins{device, logins_count};
+		std::ranges::push_heap(this->top_devices, has_more_logins);
+	}
+}
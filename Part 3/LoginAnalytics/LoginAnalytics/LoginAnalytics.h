@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Потоковая аналитика логинов по схеме players(id, name, login_time, device).
+// Заменяет запросы из select.sql, которые на каждый вызов полностью сканируют таблицу
+// (GROUP BY device и COUNT(DISTINCT DATE(login_time))): счётчики обновляются при каждом логине,
+// а ответы на запросы строятся за O(K) и O(days_window)
+class LoginAnalytics final
+{
+public:
+	using Device = std::int32_t;
+	using LoginsCount = std::uint64_t;
+	using TimeStamp = std::chrono::sys_seconds; // DATETIME без часового пояса
+
+	struct DeviceLogins final
+	{
+		Device device;
+		LoginsCount logins_count;
+	};
+
+public:
+	LoginAnalytics() = delete;
+	LoginAnalytics(std::size_t top_devices_count, std::size_t days_window);
+
+	void on_login(Device device, TimeStamp login_time);
+
+	// Аналог SELECT device, COUNT(*) ... GROUP BY device ORDER BY 2 DESC LIMIT top_devices_count.
+	// При равенстве количества логинов порядок устройств, как и в SQL, не определён
+	[[nodiscard]] std::vector<DeviceLogins> get_top_devices() const;
+
+	// Аналог COUNT(*) / COUNT(DISTINCT DATE(login_time)) для login_time >= today - (days_window - 1).
+	// Дни без логинов в делитель не входят; если логинов нет вовсе - std::nullopt (NULL в SQL).
+	// today не должен быть раньше последнего учтённого логина больше чем на days_window дней
+	[[nodiscard]] std::optional<double> get_average_logins_per_day(std::chrono::sys_days today) const noexcept;
+
+private:
+	// Корзина кольцевого буфера за один день; корзина переиспользуется, когда приходит логин за более поздний день
+	struct DayBucket final
+	{
+		std::chrono::sys_days day;
+		LoginsCount logins_count;
+	};
+
+	std::unordered_map<Device, LoginsCount> device_logins;
+	std::vector<DeviceLogins> top_devices; // min-куча по logins_count, не больше top_devices_count элементов
+	std::vector<DayBucket> day_buckets;    // индекс корзины - номер дня по модулю days_window
+	std::size_t top_devices_count;
+	mutable std::mutex mtx;
+
+	void update_top_devices(Device device, LoginsCount logins_count);
+};
@@ -0,0 +1,11 @@
+
+#include <iostream>
+
+int main()
+{
+	std::clog << "!!!WARNING!!! This project should not be launched, its just empty. Run UnitTests project (UnitTests.exe or LoginAnalytics_test.exe) instead\n";
+	std::cout << "Press any button to close this window..." << std::endl;
+	std::cin.get();
+
+	return 0;
+}
\ No newline at end of file
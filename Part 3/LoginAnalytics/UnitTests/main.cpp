@@ -0,0 +1,403 @@
+
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <array>
+#include <ranges>
+#include <algorithm>
+#include <future>
+#include <execution>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <map>
+#include <set>
+#include <cmath>
+
+#include "../LoginAnalytics/LoginAnalytics.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+static void enable_virtual_terminal()
+{
+#ifdef _WIN32
+	HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+	if (hOut == INVALID_HANDLE_VALUE) return;
+
+	DWORD dwMode = 0;
+	if (!GetConsoleMode(hOut, &dwMode)) return;
+
+	dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+	SetConsoleMode(hOut, dwMode);
+#endif
+}
+
+namespace test
+{
+	inline namespace stream_output
+	{
+		static void print_test_passed(std::string_view msg) noexcept
+		{
+			static constexpr std::string_view SUCCESS_FMT = "\033[32m[OK]   \033[0m{}\n";
+			std::clog << std::format(SUCCESS_FMT, msg);
+		}
+
+		static void print_test_failed(std::string_view msg) noexcept
+		{
+			static constexpr std::string_view FAIL_FMT = "\033[31m[FAIL] \033[0m{}\n";
+			std::cerr << std::format(FAIL_FMT, msg);
+		}
+	}
+
+	inline namespace players_table
+	{
+		using namespace std::chrono;
+
+		// Путь относительно папки проекта UnitTests (рабочая папка по умолчанию при запуске из IDE)
+		static constexpr std::string_view PLAYERS_DUMP_PATH = "../../players_dump.sql";
+
+		// Дата создания дампа: от неё отсчитываются "последние 7 дней" в запросе из select.sql
+		static constexpr sys_days PLAYERS_DUMP_DAY = 2025y / July / 16;
+
+		struct PlayerRow
+		{
+			LoginAnalytics::Device device;
+			LoginAnalytics::TimeStamp login_time;
+		};
+
+		static LoginAnalytics::TimeStamp make_time_stamp(year_month_day day, int hour, int minute, int second) noexcept
+		{
+			return sys_days{day} + hours{hour} + minutes{minute} + seconds{second};
+		}
+
+		static int parse_int(std::string_view text) noexcept
+		{
+			int value = 0;
+			std::from_chars(text.data(), text.data() + text.size(), value);
+			return value;
+		}
+
+		// Разбирает строки вида (1,'Alex','2025-07-07 17:55:25',10) из INSERT INTO `players` VALUES ...
+		static std::vector<PlayerRow> load_players_dump()
+		{
+			std::ifstream dump_file{std::string(PLAYERS_DUMP_PATH)};
+			std::stringstream dump_stream;
+			dump_stream << dump_file.rdbuf();
+			const std::string dump = dump_stream.str();
+
+			static constexpr std::string_view VALUES_BEGIN = "INSERT INTO `players` VALUES ";
+			static constexpr std::size_t DATETIME_LENGTH = std::string_view("YYYY-MM-DD HH:MM:SS").size();
+
+			std::vector<PlayerRow> rows;
+			for (std::size_t pos = dump.find(VALUES_BEGIN); pos != std::string::npos; pos = dump.find(VALUES_BEGIN, pos))
+			{
+				const std::size_t end = dump.find(";\n", pos);
+				pos += VALUES_BEGIN.size();
+				while (pos < end && dump[pos] == '(')
+				{
+					const std::size_t time_begin = dump.find("','", pos) + 3;
+					const std::string_view time(dump.data() + time_begin, DATETIME_LENGTH);
+					const std::size_t device_begin = time_begin + DATETIME_LENGTH + 2;
+					const std::size_t device_end = dump.find(')', device_begin);
+
+					const year_month_day day{
+						year{parse_int(time.substr(0, 4))},
+						month{static_cast<unsigned>(parse_int(time.substr(5, 2)))},
+						std::chrono::day{static_cast<unsigned>(parse_int(time.substr(8, 2)))}};
+
+					rows.push_back(PlayerRow{
+						parse_int(std::string_view(dump.data() + device_begin, device_end - device_begin)),
+						make_time_stamp(day, parse_int(time.substr(11, 2)), parse_int(time.substr(14, 2)), parse_int(time.substr(17, 2)))});
+
+					pos = device_end + 2; // пропускаем "),"
+				}
+			}
+			return rows;
+		}
+	}
+
+	namespace compiletime
+	{
+		namespace is_noexcept
+		{
+			static void average_logins_per_day() noexcept
+			{
+				if constexpr (noexcept(std::declval<const LoginAnalytics&>().get_average_logins_per_day(std::declval<std::chrono::sys_days>())))
+					print_test_passed("LoginAnalytics average logins per day query is noexcept");
+				else
+					print_test_failed("LoginAnalytics average logins per day query is NOT noexcept");
+			}
+
+			static void copyable_device_logins() noexcept
+			{
+				if constexpr (std::is_nothrow_copy_constructible_v<LoginAnalytics::DeviceLogins> &&
+							  std::is_nothrow_copy_assignable_v<LoginAnalytics::DeviceLogins> &&
+							  std::is_nothrow_destructible_v<LoginAnalytics::DeviceLogins>)
+					print_test_passed("DeviceLogins is fully noexcept-copyable and destructible");
+				else
+					print_test_failed("DeviceLogins is NOT fully noexcept-copyable or destructible");
+			}
+
+			static constexpr std::array TESTS
+			{
+				average_logins_per_day, copyable_device_logins
+			};
+		}
+	}
+
+	namespace runtime
+	{
+		using namespace std::chrono;
+
+		static void top_devices_ordering()
+		{
+			LoginAnalytics analytics(3, 7);
+			const auto now = make_time_stamp(2025y / July / 16, 12, 0, 0);
+
+			for (int i = 0; i < 5; ++i) analytics.on_login(7, now);
+			for (int i = 0; i < 2; ++i) analytics.on_login(3, now);
+			for (int i = 0; i < 9; ++i) analytics.on_login(1, now);
+
+			const auto top = analytics.get_top_devices();
+
+			const bool passed = top.size() == 3 &&
+								top[0].device == 1 && top[0].logins_count == 9 &&
+								top[1].device == 7 && top[1].logins_count == 5 &&
+								top[2].device == 3 && top[2].logins_count == 2;
+
+			if (passed)
+				print_test_passed("Top devices are ordered by logins count");
+			else
+				print_test_failed("Top devices ordering is broken");
+		}
+
+		static void top_devices_limit()
+		{
+			LoginAnalytics analytics(2, 7);
+			const auto now = make_time_stamp(2025y / July / 16, 12, 0, 0);
+
+			analytics.on_login(1, now);
+			analytics.on_login(2, now);
+			analytics.on_login(2, now);
+			analytics.on_login(3, now);
+			analytics.on_login(3, now);
+			analytics.on_login(3, now); // устройство 3 должно вытеснить устройство 1
+
+			const auto top = analytics.get_top_devices();
+
+			const bool passed = top.size() == 2 &&
+								top[0].device == 3 && top[0].logins_count == 3 &&
+								top[1].device == 2 && top[1].logins_count == 2;
+
+			if (passed)
+				print_test_passed("Top devices limit and eviction logic works");
+			else
+				print_test_failed("Top devices limit logic failed");
+		}
+
+		static void average_over_active_days()
+		{
+			LoginAnalytics analytics(5, 7);
+			const year_month_day today = 2025y / July / 16;
+
+			analytics.on_login(1, make_time_stamp(today, 1, 0, 0));
+			analytics.on_login(1, make_time_stamp(today, 2, 0, 0));
+			analytics.on_login(1, make_time_stamp(today, 3, 0, 0));
+			analytics.on_login(2, make_time_stamp(2025y / July / 13, 23, 59, 59));
+
+			// 4 логина за 2 дня с логинами (дни без логинов в делитель не входят)
+			const auto average = analytics.get_average_logins_per_day(sys_days{today});
+
+			if (average.has_value() && *average == 2.)
+				print_test_passed("Average logins per day ignores days without logins");
+			else
+				print_test_failed("Average logins per day is computed incorrectly");
+		}
+
+		static void average_window_bounds()
+		{
+			LoginAnalytics analytics(5, 7);
+			const year_month_day today = 2025y / July / 16;
+
+			analytics.on_login(1, make_time_stamp(2025y / July / 10, 0, 0, 0)); // ровно 6 дней назад - входит в окно
+			analytics.on_login(1, make_time_stamp(2025y / July / 9, 23, 59, 59)); // 7 дней назад - не входит
+			analytics.on_login(1, make_time_stamp(2025y / July / 1, 12, 0, 0));  // давно вышел за окно
+
+			const auto average = analytics.get_average_logins_per_day(sys_days{today});
+			const auto top = analytics.get_top_devices();
+
+			const bool passed = average.has_value() && *average == 1. &&
+								top.size() == 1 && top[0].logins_count == 3;
+
+			if (passed)
+				print_test_passed("Only logins of the last 7 days are averaged, top devices count all logins");
+			else
+				print_test_failed("Days window bounds are broken");
+		}
+
+		static void out_of_order_logins()
+		{
+			LoginAnalytics analytics(5, 7);
+			const year_month_day today = 2025y / July / 16;
+
+			analytics.on_login(1, make_time_stamp(today, 10, 0, 0));
+			analytics.on_login(1, make_time_stamp(2025y / July / 15, 10, 0, 0));
+			analytics.on_login(1, make_time_stamp(2025y / July / 8, 10, 0, 0)); // вне окна, но пришёл последним
+			analytics.on_login(1, make_time_stamp(2025y / July / 15, 11, 0, 0));
+
+			const auto average = analytics.get_average_logins_per_day(sys_days{today});
+
+			if (average.has_value() && *average == 1.5)
+				print_test_passed("Out-of-order logins are counted correctly");
+			else
+				print_test_failed("Out-of-order logins break day buckets");
+		}
+
+		static void empty_analytics()
+		{
+			LoginAnalytics analytics(5, 7);
+
+			const bool passed = analytics.get_top_devices().empty() &&
+								!analytics.get_average_logins_per_day(sys_days{2025y / July / 16}).has_value();
+
+			if (passed)
+				print_test_passed("Empty analytics returns no devices and NULL average");
+			else
+				print_test_failed("Empty analytics returns unexpected data");
+		}
+
+		// Сравнивает результаты с запросами из select.sql, выполненными "в лоб" полным сканированием дампа
+		static void matches_players_dump()
+		{
+			const std::vector<PlayerRow> rows = load_players_dump();
+			if (rows.empty())
+			{
+				print_test_failed(std::format("Players dump is not found or empty ({})", PLAYERS_DUMP_PATH));
+				return;
+			}
+
+			LoginAnalytics analytics(5, 7);
+			for (const PlayerRow &row : rows)
+				analytics.on_login(row.device, row.login_time);
+
+			// SELECT device, COUNT(*) FROM players GROUP BY device
+			std::map<LoginAnalytics::Device, LoginAnalytics::LoginsCount> group_by_device;
+			for (const PlayerRow &row : rows)
+				++group_by_device[row.device];
+
+			std::vector<LoginAnalytics::LoginsCount> expected_top_counts;
+			std::ranges::transform(group_by_device, std::back_inserter(expected_top_counts), [](const auto &group) { return group.second; });
+			std::ranges::sort(expected_top_counts, std::greater<>());
+			expected_top_counts.resize(std::min<std::size_t>(expected_top_counts.size(), 5));
+
+			// При равных счётчиках устройства могут идти в любом порядке, поэтому сравниваются
+			// упорядоченные счётчики и счётчик каждого возвращённого устройства
+			const auto top = analytics.get_top_devices();
+			bool top_matches = top.size() == expected_top_counts.size();
+			for (std::size_t i = 0; top_matches && i < top.size(); ++i)
+			{
+				top_matches = top[i].logins_count == expected_top_counts[i] &&
+							  group_by_device[top[i].device] == top[i].logins_count;
+			}
+
+			// SELECT COUNT(*) / COUNT(DISTINCT DATE(login_time)) FROM players WHERE login_time >= CURDATE() - INTERVAL 6 DAY
+			const sys_days first_day = PLAYERS_DUMP_DAY - days{6};
+			std::set<sys_days> distinct_days;
+			std::size_t logins_count = 0;
+			for (const PlayerRow &row : rows)
+			{
+				if (row.login_time >= first_day)
+				{
+					++logins_count;
+					distinct_days.insert(floor<days>(row.login_time));
+				}
+			}
+			const double expected_average = static_cast<double>(logins_count) / static_cast<double>(distinct_days.size());
+			const auto average = analytics.get_average_logins_per_day(PLAYERS_DUMP_DAY);
+
+			// ROUND(..., 2) из select.sql
+			const bool average_matches = average.has_value() &&
+										 std::round(*average * 100.) == std::round(expected_average * 100.) &&
+										 *average == expected_average;
+
+			if (top_matches && average_matches)
+				print_test_passed(std::format("Results match select.sql over players_dump.sql ({} rows, average {:.2f})", rows.size(), *average));
+			else
+				print_test_failed("Results differ from select.sql over players_dump.sql");
+		}
+
+		static void concurrent_on_login()
+		{
+			constexpr int thread_count = 8;
+			constexpr int logins_per_thread = 1000;
+
+			LoginAnalytics analytics(thread_count, 7);
+			const auto now = make_time_stamp(2025y / July / 16, 12, 0, 0);
+			{
+				std::vector<std::jthread> threads;
+				for (int i = 0; i < thread_count; ++i)
+				{
+					threads.emplace_back([&, i]
+					{
+						for (int j = 0; j < logins_per_thread; ++j)
+							analytics.on_login(i, now);
+					});
+				}
+			}
+
+			const auto top = analytics.get_top_devices();
+			const auto average = analytics.get_average_logins_per_day(sys_days{2025y / July / 16});
+
+			const bool passed = top.size() == static_cast<std::size_t>(thread_count) &&
+								std::ranges::all_of(top, [](const auto &device) { return device.logins_count == logins_per_thread; }) &&
+								average.has_value() && *average == static_cast<double>(thread_count * logins_per_thread);
+
+			if (passed)
+				print_test_passed("Multithreaded on login worked (threadsafe)");
+			else
+				print_test_failed("Multithreaded on login failed (not threadsafe)");
+		}
+
+		static constexpr std::array TESTS
+		{
+			top_devices_ordering, top_devices_limit, average_over_active_days,
+			average_window_bounds, out_of_order_logins, empty_analytics,
+			matches_players_dump, concurrent_on_login
+		};
+	}
+}
+
+int main()
+{
+	using namespace test::stream_output;
+	enable_virtual_terminal();
+	const auto run_tests = [](const auto& tests)
+	{
+		const auto future_tests =
+			tests | std::views::transform([](const auto& test) { return std::async(test); });
+		std::for_each(std::execution::par_unseq, future_tests.begin(), future_tests.end(),
+			[](const auto& future_test) { future_test.wait(); });
+	};
+
+	std::clog << ">>> Starts compiletime-noexcept tests <<<\n";
+	{
+		using namespace test::compiletime::is_noexcept;
+		run_tests(TESTS);
+	}
+	std::clog << ">>> Ends compiletime-noexcept tests <<<\n";
+
+	std::clog << ">>> Starts runtime tests <<<\n";
+	{
+		using namespace test::runtime;
+		run_tests(TESTS);
+	}
+	std::clog << ">>> Ends runtime tests <<<\n";
+
+	std::cout << "Press any button to close this window..." << std::endl;
+	std::cin.get();
+
+	return 0;
+}
@@ -0,0 +1,220 @@
+#include "PlayersGenerator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace
+{
+	// Размер буфера, после заполнения которого строки сбрасываются в поток
+	constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+	constexpr std::string_view INSERT_BEGIN = "INSERT INTO players (`name`, `login_time`, `device`) VALUES ";
+
+	// Случайные числа строки: имя, день, время, устройство
+	constexpr std::uint64_t RANDOMS_PER_ROW = 4;
+	constexpr std::uint64_t SPLITMIX64_GAMMA = 0x9E3779B97F4A7C15;
+
+	// SplitMix64: состояние - счётчик с шагом SPLITMIX64_GAMMA, поэтому генератор переставляется
+	// на любую строку набора за O(1) и строки не зависят от разбиения на части.
+	// Распределения std::uniform_*_distribution не используются, т.к. их реализация не стандартизована
+	std::uint64_t next_random(std::uint64_t &state) noexcept
+	{
+		std::uint64_t z = (state += SPLITMIX64_GAMMA);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+		return z ^ (z >> 31);
+	}
+
+	// Число из [0, 1) по старшим 53 битам
+	double to_unit(std::uint64_t random) noexcept
+	{
+		return static_cast<double>(random >> 11) * 0x1.0p-53;
+	}
+
+	// Число из [0, bound) умножением старших 32 бит со сдвигом
+	int to_range(std::uint64_t random, std::uint32_t bound) noexcept
+	{
+		return static_cast<int>(((random >> 32) * bound) >> 32);
+	}
+
+	std::vector<double> make_zipf_cdf(std::size_t values_count, double skew)
+	{
+		std::vector<double> cdf(values_count);
+		double total = 0.;
+		for (std::size_t k = 0; k < values_count; ++k)
+		{
+			total += 1. / std::pow(static_cast<double>(k + 1), skew);
+			cdf[k] = total;
+		}
+		return cdf;
+	}
+
+	std::size_t sample(const std::vector<double> &cdf, double unit) noexcept
+	{
+		const auto found = std::ranges::upper_bound(cdf, unit * cdf.back());
+		return std::min(static_cast<std::size_t>(found - cdf.begin()), cdf.size() - 1);
+	}
+
+	void append_two_digits(std::string &out, int value)
+	{
+		out.push_back(static_cast<char>('0' + value / 10));
+		out.push_back(static_cast<char>('0' + value % 10));
+	}
+
+	// Формат DATETIME: 'YYYY-MM-DD HH:MM:SS'
+	void append_login_time(std::string &out, std::string_view date, int second_of_day)
+	{
+		out.append(date);
+		out.push_back(' ');
+		append_two_digits(out, second_of_day / 3600);
+		out.push_back(':');
+		append_two_digits(out, second_of_day / 60 % 60);
+		out.push_back(':');
+		append_two_digits(out, second_of_day % 60);
+	}
+
+	void append_int(std::string &out, int value)
+	{
+		char digits[16];
+		const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+		out.append(digits, result.ptr);
+	}
+}
+
+PlayersGenerator::PlayersGenerator(const Options &options)
+	: options(options),
+	  name_cdf(make_zipf_cdf(PLAYER_NAMES.size(), options.name_skew)),
+	  day_cdf(make_zipf_cdf(MAX_LAST_LOGIN_OFFSET_DAYS, options.day_skew)),
+	  device_cdf(make_zipf_cdf(MAX_DEVICE, options.device_skew))
+{
+	assert(("Option 'parts_count' of PlayersGenerator must not be zero", options.parts_count > 0));
+	assert(("Option 'batch_size' of PlayersGenerator must not be zero", options.batch_size > 0));
+}
+
+std::vector<std::filesystem::path> PlayersGenerator::write_files(const std::filesystem::path &directory) const
+{
+	std::filesystem::create_directories(directory);
+
+	const std::string_view extension = this->options.format == Format::LOAD_DATA ? "tsv" : "sql";
+
+	std::vector<std::filesystem::path> paths;
+	paths.reserve(this->options.parts_count);
+	for (std::size_t part_index = 0; part_index < this->options.parts_count; ++part_index)
+		paths.push_back(directory / std::format("players_{}.{}", part_index, extension));
+
+	// char, а не bool: потоки пишут в соседние элементы, а std::vector<bool> упаковывает их в биты
+	std::vector<char> failed(this->options.parts_count, false);
+	{
+		std::vector<std::jthread> threads;
+		threads.reserve(this->options.parts_count);
+		for (std::size_t part_index = 0; part_index < this->options.parts_count; ++part_index)
+		{
+			threads.emplace_back([this, &paths, &failed, part_index]
+			{
+				std::ofstream out(paths[part_index], std::ios::binary);
+				if (out)
+				{
+					this->write_part(out, part_index);
+					out.close();
+				}
+				failed[part_index] = !out;
+			});
+		}
+	}
+
+	for (std::size_t part_index = 0; part_index < this->options.parts_count; ++part_index)
+	{
+		if (failed[part_index])
+			throw std::runtime_error(std::format("Failed to write file {}", paths[part_index].string()));
+	}
+
+	return paths;
+}
+
+std::uint64_t PlayersGenerator::write_part(std::ostream &out, std::size_t part_index) const
+{
+	assert(("Argument 'part_index' in PlayersGenerator::write_part must be less than 'parts_count'", part_index < this->options.parts_count));
+
+	// Строки делятся между частями поровну, остаток достаётся первым частям
+	const std::uint64_t rows_per_part = this->options.rows_count / this->options.parts_count;
+	const std::uint64_t rows_remainder = this->options.rows_count % this->options.parts_count;
+	const std::uint64_t rows_count = rows_per_part + (part_index < rows_remainder ? 1 : 0);
+	const std::uint64_t first_row = part_index * rows_per_part + std::min<std::uint64_t>(part_index, rows_remainder);
+
+	// Даты за окно из MAX_LAST_LOGIN_OFFSET_DAYS дней форматируются один раз
+	std::array<std::string, MAX_LAST_LOGIN_OFFSET_DAYS> dates;
+	for (int offset = 0; offset < MAX_LAST_LOGIN_OFFSET_DAYS; ++offset)
+	{
+		const std::chrono::year_month_day date{this->options.today - std::chrono::days(offset)};
+		append_int(dates[offset], static_cast<int>(date.year()));
+		dates[offset].push_back('-');
+		append_two_digits(dates[offset], static_cast<int>(static_cast<unsigned>(date.month())));
+		dates[offset].push_back('-');
+		append_two_digits(dates[offset], static_cast<int>(static_cast<unsigned>(date.day())));
+	}
+
+	// Генератор переставляется на первую строку части: строка с номером row во всём наборе
+	// одинакова при любом parts_count
+	std::uint64_t random_state = this->options.seed + first_row * RANDOMS_PER_ROW * SPLITMIX64_GAMMA;
+
+	const bool insert_batches = this->options.format == Format::INSERT_BATCHES;
+
+	std::string chunk;
+	chunk.reserve(CHUNK_SIZE + INSERT_BEGIN.size() + 64);
+	for (std::uint64_t row = 0; row < rows_count; ++row)
+	{
+		const std::string_view name = PLAYER_NAMES[sample(this->name_cdf, to_unit(next_random(random_state)))];
+		const std::string &date = dates[sample(this->day_cdf, to_unit(next_random(random_state)))];
+		const int second = to_range(next_random(random_state), 24 * 60 * 60);
+		const auto device = static_cast<int>(sample(this->device_cdf, to_unit(next_random(random_state))));
+
+		if (insert_batches)
+		{
+			if (row % this->options.batch_size == 0)
+				chunk.append(INSERT_BEGIN);
+			else
+				chunk.push_back(',');
+
+			chunk.append("('").append(name).append("','");
+			append_login_time(chunk, date, second);
+			chunk.append("',");
+			append_int(chunk, device);
+			chunk.push_back(')');
+
+			if ((row + 1) % this->options.batch_size == 0 || row + 1 == rows_count)
+				chunk.append(";\n");
+		}
+		else
+		{
+			// Формат LOAD DATA INFILE по умолчанию: поля через '\t', строки через '\n'
+			chunk.append(name).push_back('\t');
+			append_login_time(chunk, date, second);
+			chunk.push_back('\t');
+			append_int(chunk, device);
+			chunk.push_back('\n');
+		}
+
+		if (chunk.size() >= CHUNK_SIZE)
+		{
+			// Ошибку записи проверяет вызывающий код по состоянию out, дальше генерировать бессмысленно
+			if (!out.write(chunk.data(), static_cast<std::streamsize>(chunk.size())))
+				return row + 1;
+			chunk.clear();
+		}
+	}
+
+	out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+	return rows_count;
+}
+
+const PlayersGenerator::Options& PlayersGenerator::get_options() const noexcept
+{
+	return this->options;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Генератор синтетических данных для таблицы players (см. init.sql).
+// Повторяет распределение хранимой процедуры populate_table_players: 15 имён, логины за последние 10 дней
+// (включая сегодняшний), устройства 0..29. Данные пишутся параллельно в отдельные файлы (по одному на поток)
+// в формате LOAD DATA INFILE либо в виде многострочных INSERT
+class PlayersGenerator final
+{
+public:
+	enum class Format
+	{
+		LOAD_DATA, INSERT_BATCHES,
+	};
+
+	// Перекос задаётся показателем распределения Ципфа: вес k-го значения равен 1 / (k + 1)^skew.
+	// При skew == 0 распределение равномерное, как RAND() в populate_table_players
+	struct Options final
+	{
+		std::uint64_t rows_count = 10'000'000;
+		std::size_t parts_count = 1;
+		Format format = Format::LOAD_DATA;
+		std::size_t batch_size = 1000; // строк в одном INSERT (только для Format::INSERT_BATCHES)
+		double name_skew = 0.;
+		double day_skew = 0.;          // значение 0 - сегодня, чем больше skew, тем "свежее" логины
+		double device_skew = 0.;
+		std::chrono::sys_days today;
+		std::uint64_t seed = 0;
+	};
+
+	static constexpr std::array<std::string_view, 15> PLAYER_NAMES
+	{
+		"Alex", "Bob", "Charlie", "Henry", "Michael",
+		"Olga", "Oleg", "Peter", "Victor", "Lena",
+		"Karl", "Philip", "Dmitry", "Yaroslav", "Sergey",
+	};
+	static constexpr int MAX_LAST_LOGIN_OFFSET_DAYS = 10;
+	static constexpr int MAX_DEVICE = 30;
+
+public:
+	PlayersGenerator() = delete;
+	explicit PlayersGenerator(const Options &options);
+
+	// Пишет parts_count файлов players_<i>.tsv (или .sql) в папку directory параллельно, по потоку на файл.
+	// Папка создаётся при необходимости; если файл не удалось открыть или записать, бросает std::runtime_error
+	[[nodiscard]] std::vector<std::filesystem::path> write_files(const std::filesystem::path &directory) const;
+
+	// Пишет строки части part_index (из parts_count). Строка определяется seed, today, перекосами
+	// и её номером во всём наборе, поэтому склеенные части совпадают при любом parts_count.
+	// Возвращает количество сгенерированных строк: при ошибке записи в out генерация прекращается
+	std::uint64_t write_part(std::ostream &out, std::size_t part_index) const;
+
+	[[nodiscard]] const Options& get_options() const noexcept;
+
+private:
+	Options options;
+
+	// Накопленные (ненормированные) веса для выборки по распределению Ципфа
+	std::vector<double> name_cdf;
+	std::vector<double> day_cdf;
+	std::vector<double> device_cdf;
+};
@@ -0,0 +1,154 @@
+
+#include <iostream>
+#include <string_view>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <thread>
+#include <algorithm>
+#include <optional>
+#include <exception>
+#include <filesystem>
+
+#include "PlayersGenerator.h"
+
+namespace
+{
+	constexpr std::string_view USAGE =
+		"Usage: PlayersGenerator [options]\n"
+		"  --rows N           number of rows (default 10000000)\n"
+		"  --threads N        number of threads and output files (default: number of cores)\n"
+		"  --format F         load-data (tab separated files for LOAD DATA INFILE) or insert (multi-row INSERT batches)\n"
+		"  --batch N          rows per INSERT statement (default 1000)\n"
+		"  --name-skew S      Zipf skew of player names (default 0 - uniform, like populate_table_players)\n"
+		"  --day-skew S       Zipf skew of login days, today is the most frequent (default 0)\n"
+		"  --device-skew S    Zipf skew of devices, device 0 is the most frequent (default 0)\n"
+		"  --today YYYY-MM-DD last day of the 10 days window (default: current local date, like CURDATE())\n"
+		"  --seed N           random seed (default 0)\n"
+		"  --out DIR          output directory (default: current directory)\n";
+
+	template<typename T>
+	std::optional<T> parse_number(std::string_view text) noexcept
+	{
+		T value{};
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (error != std::errc{} || end != text.data() + text.size())
+			return std::nullopt;
+		return value;
+	}
+
+	std::optional<std::chrono::sys_days> parse_date(std::string_view text) noexcept
+	{
+		if (text.size() != std::string_view("YYYY-MM-DD").size() || text[4] != '-' || text[7] != '-')
+			return std::nullopt;
+
+		const auto y = parse_number<int>(text.substr(0, 4));
+		const auto m = parse_number<unsigned>(text.substr(5, 2));
+		const auto d = parse_number<unsigned>(text.substr(8, 2));
+		if (!y || !m || !d)
+			return std::nullopt;
+
+		const std::chrono::year_month_day date{std::chrono::year{*y}, std::chrono::month{*m}, std::chrono::day{*d}};
+		if (!date.ok())
+			return std::nullopt;
+		return std::chrono::sys_days{date};
+	}
+
+	std::optional<PlayersGenerator::Options> parse_options(int argc, char *argv[], std::string &out_directory)
+	{
+		PlayersGenerator::Options options;
+		options.parts_count = std::max(1u, std::thread::hardware_concurrency());
+		// Местная дата, как NOW() в populate_table_players и CURDATE() в select.sql (а не дата UTC)
+		const auto local_now = std::chrono::current_zone()->to_local(std::chrono::system_clock::now());
+		options.today = std::chrono::sys_days{std::chrono::floor<std::chrono::days>(local_now).time_since_epoch()};
+
+		for (int i = 1; i + 1 < argc; i += 2)
+		{
+			const std::string_view key = argv[i];
+			const std::string_view value = argv[i + 1];
+			bool parsed = true;
+
+			if (key == "--rows")
+				parsed = (options.rows_count = parse_number<std::uint64_t>(value).value_or(0)) > 0;
+			else if (key == "--threads")
+				parsed = (options.parts_count = parse_number<std::size_t>(value).value_or(0)) > 0;
+			else if (key == "--batch")
+				parsed = (options.batch_size = parse_number<std::size_t>(value).value_or(0)) > 0;
+			else if (key == "--format" && (value == "load-data" || value == "insert"))
+				options.format = value == "insert" ? PlayersGenerator::Format::INSERT_BATCHES : PlayersGenerator::Format::LOAD_DATA;
+			else if (key == "--name-skew")
+				parsed = (options.name_skew = parse_number<double>(value).value_or(-1.)) >= 0.;
+			else if (key == "--day-skew")
+				parsed = (options.day_skew = parse_number<double>(value).value_or(-1.)) >= 0.;
+			else if (key == "--device-skew")
+				parsed = (options.device_skew = parse_number<double>(value).value_or(-1.)) >= 0.;
+			else if (key == "--today")
+				parsed = parse_date(value).transform([&options](std::chrono::sys_days today) { options.today = today; return true; }).value_or(false);
+			else if (key == "--seed")
+				parsed = parse_number<std::uint64_t>(value).transform([&options](std::uint64_t seed) { options.seed = seed; return true; }).value_or(false);
+			else if (key == "--out")
+				out_directory = value;
+			else
+				parsed = false;
+
+			if (!parsed)
+			{
+				std::cerr << std::format("Invalid option {} {}\n", key, value);
+				return std::nullopt;
+			}
+		}
+
+		if (argc % 2 == 0)
+		{
+			std::cerr << std::format("Option {} has no value\n", argv[argc - 1]);
+			return std::nullopt;
+		}
+
+		return options;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	std::string out_directory = ".";
+	const auto options = parse_options(argc, argv, out_directory);
+	if (!options)
+	{
+		std::cerr << USAGE;
+		return 1;
+	}
+
+	const PlayersGenerator generator(*options);
+
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<std::filesystem::path> paths;
+	try
+	{
+		paths = generator.write_files(out_directory);
+	}
+	catch (const std::exception &error)
+	{
+		// Команды загрузки не печатаются, иначе скрипт загрузил бы неполные данные
+		std::cerr << std::format("Error: {}\n", error.what());
+		return 1;
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	// --today печатается, т.к. вместе с --seed и перекосами определяет данные (число потоков - нет)
+	const std::chrono::year_month_day today{options->today};
+	std::clog << std::format("Generated {} rows into {} files in {:.3f} s ({:.0f} rows/s), --seed {} --today {}-{:02}-{:02}\n",
+		options->rows_count, paths.size(), elapsed.count(), static_cast<double>(options->rows_count) / elapsed.count(),
+		options->seed, static_cast<int>(today.year()), static_cast<unsigned>(today.month()), static_cast<unsigned>(today.day()));
+
+	// Команды для загрузки в MySQL (для LOAD DATA LOCAL нужен local_infile=1 на сервере и клиенте)
+	for (const auto &path : paths)
+	{
+		const std::string absolute_path = std::filesystem::absolute(path).generic_string();
+		if (options->format == PlayersGenerator::Format::LOAD_DATA)
+			std::cout << std::format("LOAD DATA LOCAL INFILE '{}' INTO TABLE players (`name`, `login_time`, `device`);\n", absolute_path);
+		else
+			std::cout << std::format("SOURCE {};\n", absolute_path);
+	}
+
+	return 0;
+}
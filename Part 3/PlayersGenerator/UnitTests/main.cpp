@@ -0,0 +1,406 @@
+
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <array>
+#include <ranges>
+#include <algorithm>
+#include <future>
+#include <execution>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <filesystem>
+#include <streambuf>
+#include <stdexcept>
+
+#include "../PlayersGenerator/PlayersGenerator.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+static void enable_virtual_terminal()
+{
+#ifdef _WIN32
+	HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+	if (hOut == INVALID_HANDLE_VALUE) return;
+
+	DWORD dwMode = 0;
+	if (!GetConsoleMode(hOut, &dwMode)) return;
+
+	dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+	SetConsoleMode(hOut, dwMode);
+#endif
+}
+
+namespace test
+{
+	inline namespace stream_output
+	{
+		static void print_test_passed(std::string_view msg) noexcept
+		{
+			static constexpr std::string_view SUCCESS_FMT = "\033[32m[OK]   \033[0m{}\n";
+			std::clog << std::format(SUCCESS_FMT, msg);
+		}
+
+		static void print_test_failed(std::string_view msg) noexcept
+		{
+			static constexpr std::string_view FAIL_FMT = "\033[31m[FAIL] \033[0m{}\n";
+			std::cerr << std::format(FAIL_FMT, msg);
+		}
+	}
+
+	inline namespace generated_rows
+	{
+		using namespace std::chrono;
+
+		struct GeneratedRow
+		{
+			std::string name;
+			std::string login_time;
+			int device;
+		};
+
+		static PlayersGenerator::Options make_options(std::uint64_t rows_count, std::size_t parts_count) noexcept
+		{
+			PlayersGenerator::Options options;
+			options.rows_count = rows_count;
+			options.parts_count = parts_count;
+			options.today = 2025y / July / 16;
+			return options;
+		}
+
+		// Разбирает строки формата LOAD DATA INFILE: name\tlogin_time\tdevice\n
+		static std::vector<GeneratedRow> parse_load_data(const std::string &text)
+		{
+			std::vector<GeneratedRow> rows;
+			std::istringstream lines(text);
+			for (std::string line; std::getline(lines, line);)
+			{
+				const std::size_t first_tab = line.find('\t');
+				const std::size_t second_tab = line.find('\t', first_tab + 1);
+
+				GeneratedRow row{line.substr(0, first_tab), line.substr(first_tab + 1, second_tab - first_tab - 1), -1};
+				std::from_chars(line.data() + second_tab + 1, line.data() + line.size(), row.device);
+				rows.push_back(std::move(row));
+			}
+			return rows;
+		}
+
+		static std::string generate_part(const PlayersGenerator &generator, std::size_t part_index)
+		{
+			std::ostringstream out;
+			generator.write_part(out, part_index);
+			return out.str();
+		}
+
+		// Приёмник, любая запись в который завершается ошибкой (как переполненный диск)
+		class FailingStreamBuf final : public std::streambuf
+		{
+		public:
+			std::size_t writes_count = 0;
+
+		protected:
+			std::streamsize xsputn(const char*, std::streamsize) override
+			{
+				++this->writes_count;
+				return 0;
+			}
+
+			int_type overflow(int_type) override
+			{
+				++this->writes_count;
+				return traits_type::eof();
+			}
+		};
+
+		static std::vector<std::size_t> count_devices(const std::vector<GeneratedRow> &rows)
+		{
+			std::vector<std::size_t> devices_count(PlayersGenerator::MAX_DEVICE);
+			for (const GeneratedRow &row : rows)
+				++devices_count[row.device];
+			return devices_count;
+		}
+	}
+
+	namespace compiletime
+	{
+		namespace procedure_constants
+		{
+			static void same_as_populate_table_players() noexcept
+			{
+				if constexpr (PlayersGenerator::PLAYER_NAMES.size() == 15 &&
+							  PlayersGenerator::MAX_LAST_LOGIN_OFFSET_DAYS == 10 &&
+							  PlayersGenerator::MAX_DEVICE == 30)
+					print_test_passed("PlayersGenerator constants match populate_table_players");
+				else
+					print_test_failed("PlayersGenerator constants differ from populate_table_players");
+			}
+
+			static constexpr std::array TESTS
+			{
+				same_as_populate_table_players
+			};
+		}
+	}
+
+	namespace runtime
+	{
+		static void rows_split_between_parts()
+		{
+			const PlayersGenerator generator(make_options(1003, 4));
+
+			std::size_t rows_count = 0;
+			bool balanced = true;
+			for (std::size_t part_index = 0; part_index < 4; ++part_index)
+			{
+				const std::size_t part_rows_count = parse_load_data(generate_part(generator, part_index)).size();
+				balanced = balanced && (part_rows_count == 250 || part_rows_count == 251);
+				rows_count += part_rows_count;
+			}
+
+			if (balanced && rows_count == 1003)
+				print_test_passed("Rows are split evenly between parts");
+			else
+				print_test_failed("Rows are split between parts incorrectly");
+		}
+
+		static void rows_match_procedure_distribution()
+		{
+			const PlayersGenerator generator(make_options(10'000, 1));
+			const auto rows = parse_load_data(generate_part(generator, 0));
+
+			const bool passed = rows.size() == 10'000 && std::ranges::all_of(rows, [](const GeneratedRow &row)
+			{
+				// Окно из 10 дней: с 07-07-2025 по 16-07-2025 включительно (как в players_dump.sql)
+				return std::ranges::find(PlayersGenerator::PLAYER_NAMES, row.name) != PlayersGenerator::PLAYER_NAMES.end() &&
+					   row.login_time.size() == std::string_view("YYYY-MM-DD HH:MM:SS").size() &&
+					   row.login_time >= "2025-07-07 00:00:00" && row.login_time <= "2025-07-16 23:59:59" &&
+					   row.device >= 0 && row.device < PlayersGenerator::MAX_DEVICE;
+			});
+
+			if (passed)
+				print_test_passed("Generated names, login times and devices are in the procedure's ranges");
+			else
+				print_test_failed("Generated rows are out of the procedure's ranges");
+		}
+
+		static void uniform_without_skew()
+		{
+			const PlayersGenerator generator(make_options(300'000, 1));
+			const auto devices_count = count_devices(parse_load_data(generate_part(generator, 0)));
+
+			// Ожидаемо 10 000 логинов на устройство; отклонение больше 5% практически невозможно
+			const bool passed = std::ranges::all_of(devices_count, [](std::size_t count) { return count > 9'500 && count < 10'500; });
+
+			if (passed)
+				print_test_passed("Devices are uniformly distributed without skew");
+			else
+				print_test_failed("Devices are not uniformly distributed without skew");
+		}
+
+		static void device_skew()
+		{
+			PlayersGenerator::Options options = make_options(300'000, 1);
+			options.device_skew = 1.;
+			const PlayersGenerator generator(options);
+			const auto devices_count = count_devices(parse_load_data(generate_part(generator, 0)));
+
+			// При skew == 1 доля устройства 0 равна 1 / H(30) ~ 25%, устройства 1 - вдвое меньше
+			const bool passed = devices_count[0] > 70'000 && devices_count[0] < 80'000 &&
+								devices_count[1] > 35'000 && devices_count[1] < 40'000 &&
+								std::ranges::is_sorted(devices_count | std::views::take(5), std::greater<>());
+
+			if (passed)
+				print_test_passed("Device skew follows Zipf distribution");
+			else
+				print_test_failed("Device skew does not follow Zipf distribution");
+		}
+
+		static void insert_batches_format()
+		{
+			PlayersGenerator::Options options = make_options(2'500, 1);
+			options.format = PlayersGenerator::Format::INSERT_BATCHES;
+			options.batch_size = 1'000;
+			const std::string text = generate_part(PlayersGenerator(options), 0);
+
+			std::size_t statements_count = 0;
+			for (std::size_t pos = text.find("INSERT INTO players"); pos != std::string::npos; pos = text.find("INSERT INTO players", pos + 1))
+				++statements_count;
+
+			const std::size_t tuples_count = std::ranges::count(text, '(') - statements_count; // "(`name`, ...)" в каждом INSERT
+			const std::size_t terminators_count = std::ranges::count(text, ';');
+
+			const bool passed = statements_count == 3 && terminators_count == 3 && tuples_count == 2'500 &&
+								text.ends_with(");\n");
+
+			if (passed)
+				print_test_passed("Multi-row INSERT batches are well-formed");
+			else
+				print_test_failed("Multi-row INSERT batches are malformed");
+		}
+
+		static void deterministic_by_seed()
+		{
+			PlayersGenerator::Options options = make_options(5'000, 2);
+			options.seed = 42;
+			const PlayersGenerator first(options);
+			const PlayersGenerator second(options);
+
+			options.seed = 43;
+			const PlayersGenerator other(options);
+
+			const bool passed = generate_part(first, 1) == generate_part(second, 1) &&
+								generate_part(first, 0) != generate_part(first, 1) &&
+								generate_part(first, 0) != generate_part(other, 0);
+
+			if (passed)
+				print_test_passed("Generated data is reproducible by seed");
+			else
+				print_test_failed("Generated data is not reproducible by seed");
+		}
+
+		static void independent_of_parts_count()
+		{
+			PlayersGenerator::Options options = make_options(10'007, 1);
+			options.seed = 42;
+			const std::string whole = generate_part(PlayersGenerator(options), 0);
+
+			options.parts_count = 3;
+			const PlayersGenerator split(options);
+			const std::string concatenated = generate_part(split, 0) + generate_part(split, 1) + generate_part(split, 2);
+
+			if (whole == concatenated)
+				print_test_passed("Generated rows do not depend on the number of parts");
+			else
+				print_test_failed("Generated rows depend on the number of parts");
+		}
+
+		static void unwritable_directory()
+		{
+			// Папку нельзя создать: на её месте уже есть файл
+			const std::filesystem::path file = std::filesystem::temp_directory_path() / "players_generator_not_a_directory";
+			std::ofstream(file) << "file";
+
+			bool thrown = false;
+			try
+			{
+				static_cast<void>(PlayersGenerator(make_options(100, 2)).write_files(file / "out"));
+			}
+			catch (const std::exception&)
+			{
+				thrown = true;
+			}
+
+			std::filesystem::remove(file);
+
+			if (thrown)
+				print_test_passed("Failure to create output files is reported");
+			else
+				print_test_failed("Failure to create output files is not reported");
+		}
+
+		static void write_failure_stops_part()
+		{
+			// ~6 МБ строк - несколько буферов по 1 МБ, но после первой ошибки записи генерация прекращается
+			FailingStreamBuf buffer;
+			std::ostream out(&buffer);
+			const std::uint64_t rows_count = PlayersGenerator(make_options(200'000, 1)).write_part(out, 0);
+
+			if (rows_count < 200'000 && buffer.writes_count == 1 && out.bad())
+				print_test_passed("Part generation stops at the first write error");
+			else
+				print_test_failed("Part generation continues after a write error");
+		}
+
+		static void unopenable_file()
+		{
+			// Файл части нельзя открыть: на его месте уже есть папка
+			const std::filesystem::path directory = std::filesystem::temp_directory_path() / "players_generator_unopenable";
+			std::filesystem::create_directories(directory / "players_1.tsv");
+
+			std::string message;
+			try
+			{
+				static_cast<void>(PlayersGenerator(make_options(100, 2)).write_files(directory));
+			}
+			catch (const std::runtime_error &error)
+			{
+				message = error.what();
+			}
+
+			std::filesystem::remove_all(directory);
+
+			if (message.find("players_1.tsv") != std::string::npos)
+				print_test_passed("Failure to open an output file is reported with its path");
+			else
+				print_test_failed("Failure to open an output file is not reported");
+		}
+
+		static void parallel_files()
+		{
+			// write_files сам создаёт отсутствующие папки
+			const std::filesystem::path directory = std::filesystem::temp_directory_path() / "players_generator_test" / "nested";
+
+			const PlayersGenerator generator(make_options(10'000, 4));
+			const auto paths = generator.write_files(directory);
+
+			bool passed = paths.size() == 4;
+			for (std::size_t part_index = 0; passed && part_index < paths.size(); ++part_index)
+			{
+				std::ifstream file(paths[part_index], std::ios::binary);
+				std::stringstream content;
+				content << file.rdbuf();
+				passed = content.str() == generate_part(generator, part_index);
+			}
+
+			std::filesystem::remove_all(directory.parent_path());
+
+			if (passed)
+				print_test_passed("Parallel files are written with the same content as sequential parts");
+			else
+				print_test_failed("Parallel files differ from sequential parts");
+		}
+
+		static constexpr std::array TESTS
+		{
+			rows_split_between_parts, rows_match_procedure_distribution, uniform_without_skew,
+			device_skew, insert_batches_format, deterministic_by_seed, independent_of_parts_count,
+			unwritable_directory, write_failure_stops_part, unopenable_file, parallel_files
+		};
+	}
+}
+
+int main()
+{
+	using namespace test::stream_output;
+	enable_virtual_terminal();
+	const auto run_tests = [](const auto& tests)
+	{
+		const auto future_tests =
+			tests | std::views::transform([](const auto& test) { return std::async(test); });
+		std::for_each(std::execution::par_unseq, future_tests.begin(), future_tests.end(),
+			[](const auto& future_test) { future_test.wait(); });
+	};
+
+	std::clog << ">>> Starts compiletime tests <<<\n";
+	{
+		using namespace test::compiletime::procedure_constants;
+		run_tests(TESTS);
+	}
+	std::clog << ">>> Ends compiletime tests <<<\n";
+
+	std::clog << ">>> Starts runtime tests <<<\n";
+	{
+		using namespace test::runtime;
+		run_tests(TESTS);
+	}
+	std::clog << ">>> Ends runtime tests <<<\n";
+
+	std::cout << "Press any button to close this window..." << std::endl;
+	std::cin.get();
+
+	return 0;
+}
@@ -0,0 +1,22 @@
+-- MySQL 9.3
+-- Сравнение хранимой процедуры populate_table_players и загрузки файлов PlayersGenerator.
+-- Перед запуском:
+--   1. PlayersGenerator --rows 1000000 --out data > load_players.sql
+--   2. SET GLOBAL local_infile = 1; (от имени администратора)
+--   3. mysql --local-infile=1 rockstone_divinecrusade < benchmark.sql (из папки с load_players.sql)
+-- Количество строк в @rows должно совпадать с --rows
+SET @rows = 1000000;
+
+TRUNCATE TABLE players;
+SET @start = NOW(6);
+CALL populate_table_players(@rows); -- см. файл populate_table_players.sql
+SELECT 'populate_table_players' AS `method`, COUNT(*) AS `rows`,
+  TIMESTAMPDIFF(MICROSECOND, @start, NOW(6)) / 1e6 AS `seconds`
+FROM players;
+
+TRUNCATE TABLE players;
+SET @start = NOW(6);
+SOURCE load_players.sql
+SELECT 'PlayersGenerator + LOAD DATA' AS `method`, COUNT(*) AS `rows`,
+  TIMESTAMPDIFF(MICROSECOND, @start, NOW(6)) / 1e6 AS `seconds`
+FROM players;